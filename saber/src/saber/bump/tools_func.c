@@ -27,3 +27,16 @@ uint32_t fletcher32(uint32_t *n, uint16_t const *var)
   sum2 = (sum2 & 0xffff) + (sum2 >> 16);
   return (sum2 << 16) | sum1;
 }
+
+uint64_t fnv1a64(uint32_t *n, uint16_t const *var)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  uint32_t words = *n;
+  while (words--) {
+    hash ^= (uint64_t)(*var & 0xff);
+    hash *= 1099511628211ULL;
+    hash ^= (uint64_t)(*var++ >> 8);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
@@ -8,6 +8,8 @@
 #ifndef SABER_BUMP_TYPE_BUMP_H_
 #define SABER_BUMP_TYPE_BUMP_H_
 
+#include <shared_mutex>
+
 #include "atlas/field/FieldSet.h"
 #include "atlas/functionspace/detail/FunctionSpaceImpl.h"
 
@@ -28,6 +30,8 @@ extern "C" {
                        const eckit::Configuration &);
   void bump_add_member_f90(const int &, const atlas::field::FieldSetImpl *,
                            const int &, const int &);
+  void bump_add_members_f90(const int &, const int &, const atlas::field::FieldSetImpl * const *,
+                            const int &, const int &);
   void bump_run_drivers_f90(const int &);
   void bump_apply_vbal_f90(const int &, const atlas::field::FieldSetImpl *);
   void bump_apply_vbal_inv_f90(const int &, const atlas::field::FieldSetImpl *);
@@ -36,17 +40,33 @@ extern "C" {
   void bump_apply_stddev_f90(const int &, const atlas::field::FieldSetImpl *);
   void bump_apply_stddev_inv_f90(const int &, const atlas::field::FieldSetImpl *);
   void bump_apply_nicas_f90(const int &, const atlas::field::FieldSetImpl *);
+  void bump_apply_nicas_batch_f90(const int &, const int &,
+                                  const atlas::field::FieldSetImpl * const *);
+  void bump_apply_nicas_diag_inv_f90(const int &, const atlas::field::FieldSetImpl *);
   void bump_get_cv_size_f90(const int &, int &);
   void bump_apply_nicas_sqrt_f90(const int &, const double *, const atlas::field::FieldSetImpl *);
   void bump_apply_nicas_sqrt_ad_f90(const int &, const atlas::field::FieldSetImpl *,
                                     const double *);
   void bump_randomize_f90(const int &, const atlas::field::FieldSetImpl *);
+  void bump_append_obs_f90(const int &, const int &, const double *, const double *);
+  void bump_remove_obs_f90(const int &, const int &, const int *);
   void bump_get_parameter_f90(const int &, const int &, const char *,
                               const atlas::field::FieldSetImpl *);
   void bump_set_parameter_f90(const int &, const int &, const char *,
                               const atlas::field::FieldSetImpl *);
   void bump_dealloc_f90(const int &);
+  void bump_get_max_threads_f90(int &);
+  void bump_set_num_threads_f90(const int &);
 }
+
+
+// Lock on the Fortran state shared by all BUMP instances (registries, interpolator cache,
+// logical units)
+inline std::shared_timed_mutex & bumpMutex() {
+  static std::shared_timed_mutex mutex;
+  return mutex;
+}
+
 }  // namespace saber
 
 #endif  // SABER_BUMP_TYPE_BUMP_H_
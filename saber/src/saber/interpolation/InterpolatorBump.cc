@@ -5,7 +5,9 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <mutex>
 #include <ostream>
+#include <shared_mutex>
 #include <string>
 
 #include "atlas/field.h"
@@ -14,6 +16,7 @@
 #include "eckit/mpi/Comm.h"
 
 #include "oops/base/InterpolatorBase.h"
+#include "saber/bump/type_bump.h"
 #include "saber/interpolation/InterpolatorBump.h"
 #include "saber/interpolation/interpolatorbump_f.h"
 
@@ -30,6 +33,7 @@ InterpolatorBump::InterpolatorBump(const eckit::Configuration & config,
                    const atlas::FunctionSpace & outfspace,
                    const atlas::field::FieldSetImpl * masks,
                    const eckit::mpi::Comm & comm) {
+  std::unique_lock<std::shared_timed_mutex> lock(bumpMutex());
   bint_create_f90(keyBumpInterpolator_, &comm, infspace.get(), outfspace.get(),
                   masks, config);
 }
@@ -37,6 +41,7 @@ InterpolatorBump::InterpolatorBump(const eckit::Configuration & config,
 // -----------------------------------------------------------------------------
   void InterpolatorBump::apply(const atlas::FieldSet & infields,
                                atlas::FieldSet & outfields) {
+  std::shared_lock<std::shared_timed_mutex> lock(bumpMutex());
   bint_apply_f90(keyBumpInterpolator_, infields.get(), outfields.get());
 }
 
@@ -46,18 +51,21 @@ InterpolatorBump::InterpolatorBump(const eckit::Configuration & config,
   atlas::FieldSet infields, outfields;
   infields.add(infield);
   outfields.add(outfield);
+  std::shared_lock<std::shared_timed_mutex> lock(bumpMutex());
   bint_apply_f90(keyBumpInterpolator_, infields.get(), outfields.get());
 }
 
 // -----------------------------------------------------------------------------
   void InterpolatorBump::apply_ad(const atlas::FieldSet & fields_grid2,
                                   atlas::FieldSet & fields_grid1) {
+  std::shared_lock<std::shared_timed_mutex> lock(bumpMutex());
   bint_apply_ad_f90(keyBumpInterpolator_, fields_grid2.get(),
                     fields_grid1.get());
 }
 
 // -----------------------------------------------------------------------------
 InterpolatorBump::~InterpolatorBump() {
+  std::unique_lock<std::shared_timed_mutex> lock(bumpMutex());
   bint_delete_f90(keyBumpInterpolator_);
 }
 
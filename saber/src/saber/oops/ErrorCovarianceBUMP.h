@@ -22,6 +22,7 @@
 #include "oops/util/Printable.h"
 #include "oops/util/Timer.h"
 
+#include "saber/oops/LazyOoBump.h"
 #include "saber/oops/OoBump.h"
 #include "saber/oops/ParametersBUMP.h"
 
@@ -46,6 +47,7 @@ class ErrorCovarianceBUMP : public oops::ModelSpaceCovarianceBase<MODEL>,
                             private util::ObjectCounter<ErrorCovarianceBUMP<MODEL>> {
   typedef oops::Geometry<MODEL>    Geometry_;
   typedef oops::Increment<MODEL>   Increment_;
+  typedef LazyOoBump<MODEL>        LazyOoBump_;
   typedef OoBump<MODEL>            OoBump_;
   typedef oops::State<MODEL>       State_;
   typedef ParametersBUMP<MODEL>    ParametersBUMP_;
@@ -57,6 +59,8 @@ class ErrorCovarianceBUMP : public oops::ModelSpaceCovarianceBase<MODEL>,
                       const eckit::Configuration &, const State_ &, const State_ &);
   virtual ~ErrorCovarianceBUMP();
 
+  void multiply(const std::vector<Increment_> &, std::vector<Increment_> &) const;
+
  private:
   ErrorCovarianceBUMP(const ErrorCovarianceBUMP&);
   ErrorCovarianceBUMP& operator=(const ErrorCovarianceBUMP&);
@@ -68,7 +72,7 @@ class ErrorCovarianceBUMP : public oops::ModelSpaceCovarianceBase<MODEL>,
 
   void print(std::ostream &) const override;
 
-  std::unique_ptr<OoBump_> ooBump_;
+  LazyOoBump_ ooBump_;
 };
 
 // =============================================================================
@@ -82,11 +86,8 @@ ErrorCovarianceBUMP<MODEL>::ErrorCovarianceBUMP(const Geometry_ & resol,
 {
   oops::Log::trace() << "ErrorCovarianceBUMP::ErrorCovarianceBUMP starting" << std::endl;
 
-// Setup parameters
-  ParametersBUMP_ param(resol, vars, xb.validTime(), conf);
-
-// Transfer OoBump pointer
-  ooBump_.reset(new OoBump_(param.getOoBump()));
+// Setup parameters and OoBump, possibly in the background
+  ooBump_.build(resol, vars, xb.validTime(), conf);
 
   oops::Log::trace() << "ErrorCovarianceBUMP::ErrorCovarianceBUMP done" << std::endl;
 }
@@ -123,6 +124,20 @@ void ErrorCovarianceBUMP<MODEL>::doMultiply(const Increment_ & dxi,
 
 // -----------------------------------------------------------------------------
 
+template<typename MODEL>
+void ErrorCovarianceBUMP<MODEL>::multiply(const std::vector<Increment_> & dxi,
+                                          std::vector<Increment_> & dxo) const {
+  oops::Log::trace() << "ErrorCovarianceBUMP<MODEL>::multiply batch starting" << std::endl;
+  util::Timer timer(classname(), "multiply batch");
+  ASSERT(dxo.size() == dxi.size());
+  for (size_t jf = 0; jf < dxi.size(); ++jf) {
+    dxo[jf] = dxi[jf];
+  }
+  ooBump_->multiplyNicas(dxo);
+  oops::Log::trace() << "ErrorCovarianceBUMP<MODEL>::multiply batch done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+
 template<typename MODEL>
 void ErrorCovarianceBUMP<MODEL>::doInverseMultiply(const Increment_ & dxi,
                                                    Increment_ & dxo) const {
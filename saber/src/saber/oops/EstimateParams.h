@@ -77,9 +77,6 @@ template <typename MODEL> class EstimateParams : public oops::Application {
     if (fullConfig.has("ensemble")) {
       const eckit::LocalConfiguration ensembleConfig(fullConfig, "ensemble");
       ens1.reset(new Ensemble_(ensembleConfig, xx, xx, resol, vars));
-      for (size_t ie = 0; ie < ens1->size(); ++ie) {
-        (*ens1)[ie].toAtlas();
-      }
     }
 
     // Setup ensemble 2
@@ -99,7 +96,6 @@ template <typename MODEL> class EstimateParams : public oops::Application {
         Increment_ incr(resol, vars, time);
         cov->randomize(incr);
         (*ens2)[ie] = incr;
-        (*ens2)[ie].toAtlas();
       }
     }
 
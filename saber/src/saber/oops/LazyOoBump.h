@@ -0,0 +1,212 @@
+/*
+ * (C) Copyright 2020 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef SABER_OOPS_LAZYOOBUMP_H_
+#define SABER_OOPS_LAZYOOBUMP_H_
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "eckit/config/Configuration.h"
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/mpi/Comm.h"
+
+#include "oops/base/Variables.h"
+#include "oops/interface/Geometry.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Logger.h"
+
+#include "saber/oops/OoBump.h"
+#include "saber/oops/ParametersBUMP.h"
+
+namespace saber {
+
+// -----------------------------------------------------------------------------
+/// OoBump built synchronously or in the background, possibly shared between users
+///
+/// With "asynchronous construction: true", the OoBump is set up on the calling thread (model
+/// increments and inputs included) and only the BUMP drivers run on a separate thread, on a
+/// dedicated duplicate of the geometry communicator, so that their collective communications
+/// cannot interfere with the rest of the initialization. This requires MPI_THREAD_MULTIPLE, the
+/// construction is synchronous otherwise, or fails if "asynchronous construction fallback" is
+/// false. The first access to the OoBump waits for the drivers to complete. The dedicated
+/// communicator is freed with the OoBump.
+///
+/// With "reuse instance: true", OoBump instances are registered in a process-wide registry keyed
+/// by the printed geometry, variables, date and configuration. A later construction with the
+/// same key (e.g. at the next outer loop) attaches to the registered instance instead of
+/// rebuilding it. The instance is shared through reference counting, and is released when its
+/// last user is destroyed. The registry is only accessed under its mutex.
+
+template<typename MODEL> class LazyOoBump {
+  typedef oops::Geometry<MODEL>    Geometry_;
+  typedef OoBump<MODEL>            OoBump_;
+  typedef ParametersBUMP<MODEL>    ParametersBUMP_;
+
+ public:
+  LazyOoBump() : ooBump_(), pending_(), future_(), commName_(), key_(), reuse_(false) {}
+  ~LazyOoBump();
+
+  void build(const Geometry_ &, const oops::Variables &, const util::DateTime &,
+             const eckit::Configuration &);
+  void reset(OoBump_ * ooBump) {wait(); ooBump_.reset(ooBump);}
+
+  OoBump_ * operator->() const {wait(); return ooBump_.get();}
+  OoBump_ & operator*() const {wait(); return *ooBump_;}
+
+ private:
+  void wait() const;
+  static std::map<std::string, std::weak_ptr<OoBump_>> & registry();
+  static std::mutex & registryMutex();
+
+  mutable std::shared_ptr<OoBump_> ooBump_;
+  mutable std::unique_ptr<OoBump_> pending_;
+  mutable std::future<void> future_;
+  mutable std::string commName_;
+  std::string key_;
+  bool reuse_;
+};
+
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+LazyOoBump<MODEL>::~LazyOoBump() {
+  // A failed background construction is only reported, a destructor must not throw
+  try {
+    wait();
+  } catch (const std::exception & e) {
+    oops::Log::error() << "LazyOoBump: asynchronous construction failed: " << e.what()
+                       << std::endl;
+  } catch (...) {
+    oops::Log::error() << "LazyOoBump: asynchronous construction failed" << std::endl;
+  }
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+void LazyOoBump<MODEL>::build(const Geometry_ & resol, const oops::Variables & vars,
+                              const util::DateTime & time, const eckit::Configuration & conf) {
+  wait();
+
+  // Registry lookup, the decision is shared by all tasks
+  reuse_ = conf.getBool("reuse instance", false);
+  if (reuse_) {
+    std::ostringstream ss;
+    ss << resol.getComm().name() << "|" << resol << "|" << vars << "|" << time << "|" << conf;
+    key_ = ss.str();
+    std::shared_ptr<OoBump_> registered;
+    {
+      std::lock_guard<std::mutex> lock(registryMutex());
+      if (registry().count(key_) > 0) registered = registry()[key_].lock();
+    }
+    int found = registered ? 1 : 0;
+    resol.getComm().allReduceInPlace(found, eckit::mpi::min());
+    if (found == 1) {
+      ooBump_ = registered;
+      oops::Log::info() << "LazyOoBump: attached to registered instance (" << ooBump_.use_count()-1
+                        << " user(s))" << std::endl;
+      return;
+    }
+  }
+
+  bool async = conf.getBool("asynchronous construction", false);
+  if (async && !mpiThreadMultiple()) {
+    if (!conf.getBool("asynchronous construction fallback", true)) {
+      throw eckit::UserError("LazyOoBump: asynchronous construction requires "
+                             "MPI_THREAD_MULTIPLE", Here());
+    }
+    oops::Log::warning() << "LazyOoBump: MPI_THREAD_MULTIPLE is not provided, construction is "
+                         << "synchronous" << std::endl;
+    async = false;
+  }
+
+  if (async) {
+    // Dedicated communicator, created collectively on the calling thread
+    static std::atomic<int> ncomm(0);
+    commName_ = "bump_async_" + std::to_string(ncomm++);
+    resol.getComm().split(0, commName_);
+
+    // BUMP configuration with the dedicated communicator
+    eckit::LocalConfiguration asyncConf(conf);
+    eckit::LocalConfiguration BUMPConf(conf, "bump");
+    BUMPConf.set("communicator", commName_);
+    asyncConf.set("bump", BUMPConf);
+
+    // Setup on the calling thread, only the drivers run in the background
+    try {
+      ParametersBUMP_ param(resol, vars, time, asyncConf, NULL, NULL, false);
+      pending_.reset(new OoBump_(param.getOoBump()));
+    } catch (...) {
+      eckit::mpi::deleteComm(commName_.c_str());
+      commName_.clear();
+      throw;
+    }
+    oops::Log::info() << "LazyOoBump: asynchronous construction on communicator " << commName_
+                      << std::endl;
+    const OoBump_ * ooBump = pending_.get();
+    future_ = std::async(std::launch::async, [ooBump]() {ooBump->runDrivers();});
+  } else {
+    // Synchronous construction
+    ParametersBUMP_ param(resol, vars, time, conf);
+    ooBump_.reset(new OoBump_(param.getOoBump()));
+    if (reuse_) {
+      std::lock_guard<std::mutex> lock(registryMutex());
+      registry()[key_] = ooBump_;
+    }
+  }
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+void LazyOoBump<MODEL>::wait() const {
+  if (future_.valid()) {
+    oops::Log::info() << "LazyOoBump: waiting for the asynchronous construction" << std::endl;
+    const std::string commName = commName_;
+    commName_.clear();
+    std::unique_ptr<OoBump_> ooBump(pending_.release());
+    try {
+      future_.get();
+    } catch (...) {
+      ooBump.reset();
+      eckit::mpi::deleteComm(commName.c_str());
+      throw;
+    }
+
+    // The dedicated communicator is freed after the OoBump, by its last user
+    ooBump_ = std::shared_ptr<OoBump_>(ooBump.release(), [commName](OoBump_ * ptr) {
+      delete ptr;
+      eckit::mpi::deleteComm(commName.c_str());
+    });
+    if (reuse_) {
+      std::lock_guard<std::mutex> lock(registryMutex());
+      registry()[key_] = ooBump_;
+    }
+  }
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+std::map<std::string, std::weak_ptr<OoBump<MODEL>>> & LazyOoBump<MODEL>::registry() {
+  static std::map<std::string, std::weak_ptr<OoBump_>> registry_;
+  return registry_;
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+std::mutex & LazyOoBump<MODEL>::registryMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+// -----------------------------------------------------------------------------
+
+}  // namespace saber
+
+#endif  // SABER_OOPS_LAZYOOBUMP_H_
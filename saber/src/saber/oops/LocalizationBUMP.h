@@ -8,12 +8,16 @@
 #ifndef SABER_OOPS_LOCALIZATIONBUMP_H_
 #define SABER_OOPS_LOCALIZATIONBUMP_H_
 
+#include <exception>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include "eckit/config/Configuration.h"
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/mpi/Comm.h"
 
 #include "oops/base/LocalizationBase.h"
 #include "oops/base/Variables.h"
@@ -21,6 +25,7 @@
 #include "oops/util/Duration.h"
 #include "oops/util/Logger.h"
 
+#include "saber/oops/LazyOoBump.h"
 #include "saber/oops/OoBump.h"
 #include "saber/oops/ParametersBUMP.h"
 
@@ -41,6 +46,7 @@ template<typename MODEL>
 class LocalizationBUMP : public oops::LocalizationBase<MODEL> {
   typedef oops::Geometry<MODEL>                           Geometry_;
   typedef oops::Increment<MODEL>                          Increment_;
+  typedef LazyOoBump<MODEL>                               LazyOoBump_;
   typedef OoBump<MODEL>                                   OoBump_;
   typedef ParametersBUMP<MODEL>                           ParametersBUMP_;
 
@@ -49,11 +55,14 @@ class LocalizationBUMP : public oops::LocalizationBase<MODEL> {
   ~LocalizationBUMP();
 
   void multiply(Increment_ &) const override;
+  void multiply(std::vector<Increment_> &) const;
 
  private:
   void print(std::ostream &) const override;
+  eckit::LocalConfiguration writeConf(const eckit::Configuration &) const;
+  eckit::LocalConfiguration readConf(const eckit::Configuration &, const bool &) const;
 
-  std::unique_ptr<OoBump_> ooBump_;
+  LazyOoBump_ ooBump_;
 };
 
 // =============================================================================
@@ -68,12 +77,37 @@ LocalizationBUMP<MODEL>::LocalizationBUMP(const Geometry_ & resol,
   const oops::Variables vars(conf, "localization variables");
 
   size_t myslot = resol.timeComm().rank();
-  if (myslot == 0) {
-  // Setup parameters
-    ParametersBUMP_ param(resol, vars, time, conf);
-
-  // Transfer OoBump pointer
-    ooBump_.reset(new OoBump_(param.getOoBump()));
+  if (conf.getBool("share nicas across time slots", false)) {
+  // Slot 0 sets up the NICAS operator, the other slots read it from the same files
+    const eckit::LocalConfiguration BUMPConf(conf, "bump");
+    const bool loaded = BUMPConf.getBool("load_nicas", false)
+                        && !BUMPConf.getBool("new_nicas", false);
+    std::exception_ptr eptr;
+    if (myslot == 0) {
+      try {
+        // A loaded operator is never written again
+        eckit::LocalConfiguration slotConf(conf);
+        if (!loaded) slotConf = writeConf(conf);
+        ooBump_.build(resol, vars, time, slotConf);
+
+        // Wait for a background construction
+        *ooBump_;
+      } catch (...) {
+        eptr = std::current_exception();
+      }
+    }
+
+  // Slot 0 status, shared instead of a barrier so that the other slots do not wait for a failed
+  // setup
+    int failed = eptr ? 1 : 0;
+    resol.timeComm().allReduceInPlace(failed, eckit::mpi::max());
+    if (eptr) std::rethrow_exception(eptr);
+    if (failed == 1) throw eckit::Exception("LocalizationBUMP: NICAS setup failed on slot 0",
+                                            Here());
+    if (myslot > 0) ooBump_.build(resol, vars, time, readConf(conf, loaded));
+  } else if (myslot == 0) {
+  // Setup parameters and OoBump, possibly in the background
+    ooBump_.build(resol, vars, time, conf);
   }
 
   oops::Log::trace() << "LocalizationBUMP:LocalizationBUMP constructed" << std::endl;
@@ -97,6 +131,52 @@ void LocalizationBUMP<MODEL>::multiply(Increment_ & dx) const {
 
 // -----------------------------------------------------------------------------
 
+template<typename MODEL>
+void LocalizationBUMP<MODEL>::multiply(std::vector<Increment_> & dxs) const {
+  oops::Log::trace() << "LocalizationBUMP:multiply batch starting" << std::endl;
+  ooBump_->multiplyNicas(dxs);
+  oops::Log::trace() << "LocalizationBUMP:multiply batch done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+eckit::LocalConfiguration LocalizationBUMP<MODEL>::writeConf(const eckit::Configuration & conf)
+  const {
+// Configuration of slot 0, writing the new NICAS operator in the memory-mapped binary format
+  eckit::LocalConfiguration confWrite(conf);
+  eckit::LocalConfiguration BUMPConf(conf, "bump");
+  BUMPConf.set("write_nicas", true);
+  BUMPConf.set("nicas_format", "binary");
+  confWrite.set("bump", BUMPConf);
+  return confWrite;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+eckit::LocalConfiguration LocalizationBUMP<MODEL>::readConf(const eckit::Configuration & conf,
+                                                            const bool & loaded) const {
+// Configuration to read the NICAS operator loaded or written by slot 0, without running any other
+// driver and without writing anything: files written by slot 0 are mapped read-only, files
+// loaded by slot 0 are read in their own format
+  eckit::LocalConfiguration confRead(conf);
+  eckit::LocalConfiguration BUMPConf(conf, "bump");
+  const std::vector<std::string> drivers = {"new_normality", "new_vbal", "load_vbal", "new_var",
+    "load_var", "new_mom", "load_mom", "new_hdiag", "new_lct", "load_cmat", "new_nicas",
+    "convert_nicas", "new_obsop", "load_obsop"};
+  for (const auto & driver : drivers) BUMPConf.set(driver, false);
+  const std::vector<std::string> outputs = {"write_vbal", "write_var", "write_mom", "write_hdiag",
+    "write_lct", "write_cmat", "write_nicas", "write_obsop"};
+  for (const auto & output : outputs) BUMPConf.set(output, false);
+  BUMPConf.set("load_nicas", true);
+  if (!loaded) BUMPConf.set("nicas_format", "binary");
+  confRead.set("bump", BUMPConf);
+  confRead.set("input", std::vector<eckit::LocalConfiguration>());
+  return confRead;
+}
+
+// -----------------------------------------------------------------------------
+
 template<typename MODEL>
 void LocalizationBUMP<MODEL>::print(std::ostream & os) const {
   os << "LocalizationBUMP:print not implemeted yet";
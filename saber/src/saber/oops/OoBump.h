@@ -8,10 +8,19 @@
 #ifndef SABER_OOPS_OOBUMP_H_
 #define SABER_OOPS_OOBUMP_H_
 
+#include <mpi.h>
+
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -19,10 +28,11 @@
 #include "atlas/functionspace.h"
 
 #include "eckit/config/Configuration.h"
+#include "eckit/exception/Exceptions.h"
 #include "eckit/mpi/Comm.h"
 
 #include "oops/assimilation/GMRESR.h"
-#include "oops/base/IdentityMatrix.h"
+#include "oops/assimilation/PCG.h"
 #include "oops/base/Variables.h"
 #if !ATLASIFIED
 #include "oops/generic/UnstructuredGrid.h"
@@ -44,12 +54,28 @@ namespace oops {
 
 namespace saber {
 
+// -----------------------------------------------------------------------------
+/// Check that MPI supports concurrent calls from several threads
+inline bool mpiThreadMultiple() {
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  return provided >= MPI_THREAD_MULTIPLE;
+}
+
 // -----------------------------------------------------------------------------
 /// OoBump C++ interface
+///
+/// The Fortran interfaces below use FieldSet buffers cached in the instance, so although they are
+/// const, they are not reentrant: they must not be called concurrently on the same instance.
+///
+/// The Fortran state shared by all BUMP instances (registry, logical units) is protected by
+/// bumpMutex: creation, drivers and deallocation lock it exclusively, other calls share it.
 
 template<typename MODEL> class OoBump {
   typedef oops::Geometry<MODEL>    Geometry_;
   typedef oops::Increment<MODEL>   Increment_;
+  typedef std::vector<const atlas::field::FieldSetImpl *> FieldSetImpls_;
+  typedef std::map<std::pair<std::string, size_t>, std::unique_ptr<atlas::FieldSet>> FieldSetMap_;
 
  public:
   OoBump(const Geometry_ &, const oops::Variables &, const util::DateTime &,
@@ -64,6 +90,7 @@ template<typename MODEL> class OoBump {
 
   // Fortran interfaces
   void addMember(const atlas::FieldSet & atlasFieldSet, const int &, const int &) const;
+  void addMembers(const std::vector<const atlas::FieldSet *> &, const int &, const int &) const;
   void runDrivers() const;
   void multiplyVbal(const Increment_ &, Increment_ &) const;
   void multiplyVbalInv(const Increment_ &, Increment_ &) const;
@@ -73,16 +100,46 @@ template<typename MODEL> class OoBump {
   void multiplyStdDevInv(const Increment_ &, Increment_ &) const;
   void multiplyNicas(Increment_ &) const;
   void multiplyNicas(const Increment_ &, Increment_ &) const;
+  void multiplyNicas(std::vector<Increment_> &) const;
   void inverseMultiplyNicas(const Increment_ &, Increment_ &) const;
+  void multiplyNicasDiagInv(const Increment_ &, Increment_ &) const;
   void randomize(Increment_ &) const;
+  void appendObs(const std::vector<double> &, const std::vector<double> &) const;
+  void removeObs(const std::vector<bool> &) const;
   void getParameter(const std::string &, Increment_ &) const;
   void setParameter(const std::string &, const Increment_ &) const;
 
-  // Aliases for inversion with GMRESR
-  void multiply(const Increment_ & dxi, Increment_ & dxo) const {multiplyNicas(dxi, dxo);}
+  // Aliases for inversion with PCG or GMRESR
+  void multiply(const Increment_ & dxi, Increment_ & dxo) const {
+    ++nmultiply_;
+    multiplyNicas(dxi, dxo);
+  }
 
  private:
+  // Jacobi preconditioner for the NICAS inverse
+  class NicasDiagInv {
+   public:
+    explicit NicasDiagInv(const OoBump & ooBump): ooBump_(ooBump) {}
+    void multiply(const Increment_ & dxi, Increment_ & dxo) const {
+      ooBump_.multiplyNicasDiagInv(dxi, dxo);
+    }
+   private:
+    const OoBump & ooBump_;
+  };
+
+  atlas::FieldSet * getFieldSet(const Increment_ &, const size_t & jf = 0) const;
+  template<typename FUNC> void applyGrids(const std::vector<atlas::FieldSet *> &,
+                                          const FUNC &) const;
+
   std::vector<int> keyOoBump_;
+  std::vector<std::vector<std::string>> gridVars_;
+  std::vector<std::string> commNames_;
+  std::vector<int> nthreads_;
+  mutable FieldSetMap_ atlasFieldSets_;
+  std::string inverseSolver_;
+  int inverseNiter_;
+  double inverseTolerance_;
+  mutable int nmultiply_;
 };
 
 // -----------------------------------------------------------------------------
@@ -90,7 +147,11 @@ template<typename MODEL>
 OoBump<MODEL>::OoBump(const Geometry_ & resol,
                       const oops::Variables & vars,
                       const util::DateTime & time,
-                      const eckit::LocalConfiguration conf) : keyOoBump_() {
+                      const eckit::LocalConfiguration conf)
+  : keyOoBump_(), gridVars_(), commNames_(), nthreads_(), atlasFieldSets_(),
+    inverseSolver_(conf.getString("inverse_solver", "pcg")),
+    inverseNiter_(conf.getInt("inverse_niter", 10)),
+    inverseTolerance_(conf.getDouble("inverse_tolerance", 1.0e-3)), nmultiply_(0) {
   // Grids
   std::vector<eckit::LocalConfiguration> grids;
 
@@ -174,19 +235,69 @@ OoBump<MODEL>::OoBump(const Geometry_ & resol,
   // Print configuration
   oops::Log::info() << "Configuration: " << conf << std::endl;
 
+  // Concurrent application of the grids
+  // - each grid gets its own duplicate of the geometry communicator, so that the collective
+  //   communications of different grids cannot match each other (requires MPI_THREAD_MULTIPLE,
+  //   the grids are applied sequentially otherwise, unless concurrent_grids_fallback is false)
+  // - each grid gets a share of the OpenMP threads proportional to its cost (variables x levels)
+  bool concurrent = conf.getBool("concurrent_grids", false) && (grids.size() > 1);
+  if (concurrent && !mpiThreadMultiple()) {
+    if (!conf.getBool("concurrent_grids_fallback", true)) {
+      throw eckit::UserError("OoBump: concurrent grids require MPI_THREAD_MULTIPLE", Here());
+    }
+    oops::Log::warning() << "OoBump: MPI_THREAD_MULTIPLE is not provided, grids are applied "
+                         << "sequentially" << std::endl;
+    concurrent = false;
+  }
+  if (concurrent) {
+    int nthreadsTot = 1;
+    bump_get_max_threads_f90(nthreadsTot);
+    std::vector<double> cost;
+    double costTot = 0.0;
+    for (unsigned int jgrid = 0; jgrid < grids.size(); ++jgrid) {
+      const int nv = grids[jgrid].getInt("nv", 1);
+      const int nl = grids[jgrid].getInt("nl", 1);
+      cost.push_back(static_cast<double>(nv*std::max(nl, 1)));
+      costTot += cost[jgrid];
+    }
+    for (unsigned int jgrid = 0; jgrid < grids.size(); ++jgrid) {
+      nthreads_.push_back(std::max(1, static_cast<int>(nthreadsTot*cost[jgrid]/costTot)));
+    }
+  }
+
   for (unsigned int jgrid = 0; jgrid < grids.size(); ++jgrid) {
     // Print configuration for this grid
     oops::Log::info() << "Grid " << jgrid << ": " << grids[jgrid] << std::endl;
 
+    // Variables of this grid
+    std::vector<std::string> vars_str;
+    grids[jgrid].get("variables", vars_str);
+    gridVars_.push_back(vars_str);
+
+    // Communicator for this grid (the geometry communicator, unless a named one is provided)
+    const eckit::mpi::Comm * comm = &resol.getComm();
+    if (conf.has("communicator")) comm = &eckit::mpi::comm(conf.getString("communicator").c_str());
+    if (concurrent) {
+      // Name unique within the process, the communicator is freed with the instance
+      static std::atomic<int> ncomm(0);
+      const std::string commName = grids[jgrid].getString("prefix") + "_comm_"
+                                   + std::to_string(ncomm++);
+      comm = &comm->split(0, commName);
+      commNames_.push_back(commName);
+      oops::Log::info() << "Grid " << jgrid << " applied concurrently with " << nthreads_[jgrid]
+                        << " thread(s)" << std::endl;
+    }
+
     // Create OoBump instance
+    std::unique_lock<std::shared_timed_mutex> lock(bumpMutex());
     int keyOoBump = 0;
 #if ATLASIFIED
-    bump_create_f90(keyOoBump, &resol.getComm(),
+    bump_create_f90(keyOoBump, comm,
                     resol.atlasFunctionSpace()->get(),
                     resol.atlasFieldSet()->get(),
                     conf, grids[jgrid]);
 #else
-    bump_create_f90(keyOoBump, &resol.getComm(),
+    bump_create_f90(keyOoBump, comm,
                     ug.atlasFunctionSpace()->get(),
                     ug.atlasFieldSet()->get(),
                     conf, grids[jgrid]);
@@ -196,30 +307,53 @@ OoBump<MODEL>::OoBump(const Geometry_ & resol,
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
-OoBump<MODEL>::OoBump(OoBump & other) : keyOoBump_() {
+OoBump<MODEL>::OoBump(OoBump & other)
+  : keyOoBump_(), gridVars_(other.gridVars_), commNames_(std::move(other.commNames_)),
+    nthreads_(other.nthreads_), atlasFieldSets_(std::move(other.atlasFieldSets_)),
+    inverseSolver_(other.inverseSolver_), inverseNiter_(other.inverseNiter_),
+    inverseTolerance_(other.inverseTolerance_), nmultiply_(0) {
   for (unsigned int jgrid = 0; jgrid < other.getSize(); ++jgrid) {
     keyOoBump_.push_back(other.getKey(jgrid));
   }
   other.clearKey();
+  other.commNames_.clear();
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 OoBump<MODEL>::~OoBump() {
+  std::unique_lock<std::shared_timed_mutex> lock(bumpMutex());
   for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
     if (keyOoBump_[jgrid] > 0) bump_dealloc_f90(keyOoBump_[jgrid]);
   }
+  for (const auto & commName : commNames_) eckit::mpi::deleteComm(commName.c_str());
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::addMember(const atlas::FieldSet & atlasFieldSet, const int & ie,
                                const int & iens) const {
+  std::shared_lock<std::shared_timed_mutex> lock(bumpMutex());
   for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
     bump_add_member_f90(keyOoBump_[jgrid], atlasFieldSet.get(), ie+1, iens);
   }
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
+void OoBump<MODEL>::addMembers(const std::vector<const atlas::FieldSet *> & atlasFieldSets,
+                               const int & ie, const int & iens) const {
+  const int nmem = atlasFieldSets.size();
+  std::vector<const atlas::field::FieldSetImpl *> atlasFieldSetImpls;
+  for (int jmem = 0; jmem < nmem; ++jmem) {
+    atlasFieldSetImpls.push_back(atlasFieldSets[jmem]->get());
+  }
+  std::shared_lock<std::shared_timed_mutex> lock(bumpMutex());
+  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
+    bump_add_members_f90(keyOoBump_[jgrid], nmem, atlasFieldSetImpls.data(), ie+1, iens);
+  }
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
 void OoBump<MODEL>::runDrivers() const {
+  std::unique_lock<std::shared_timed_mutex> lock(bumpMutex());
   for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
     bump_run_drivers_f90(keyOoBump_[jgrid]);
   }
@@ -227,121 +361,258 @@ void OoBump<MODEL>::runDrivers() const {
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::multiplyVbal(const Increment_ & dxi, Increment_ & dxo) const {
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dxi.toAtlas(atlasFieldSet.get());
-  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_apply_vbal_f90(keyOoBump_[jgrid], atlasFieldSet->get());
-  }
-  dxo.fromAtlas(atlasFieldSet.get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dxi);
+  dxi.toAtlas(atlasFieldSet);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_apply_vbal_f90(keyOoBump, impls[0]);
+  });
+  dxo.fromAtlas(atlasFieldSet);
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::multiplyVbalInv(const Increment_ & dxi, Increment_ & dxo) const {
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dxi.toAtlas(atlasFieldSet.get());
-  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_apply_vbal_inv_f90(keyOoBump_[jgrid], atlasFieldSet->get());
-  }
-  dxo.fromAtlas(atlasFieldSet.get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dxi);
+  dxi.toAtlas(atlasFieldSet);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_apply_vbal_inv_f90(keyOoBump, impls[0]);
+  });
+  dxo.fromAtlas(atlasFieldSet);
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::multiplyVbalAd(const Increment_ & dxi, Increment_ & dxo) const {
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dxi.toAtlas(atlasFieldSet.get());
-  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_apply_vbal_ad_f90(keyOoBump_[jgrid], atlasFieldSet->get());
-  }
-  dxo.fromAtlas(atlasFieldSet.get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dxi);
+  dxi.toAtlas(atlasFieldSet);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_apply_vbal_ad_f90(keyOoBump, impls[0]);
+  });
+  dxo.fromAtlas(atlasFieldSet);
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::multiplyVbalInvAd(const Increment_ & dxi, Increment_ & dxo) const {
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dxi.toAtlas(atlasFieldSet.get());
-  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_apply_vbal_inv_ad_f90(keyOoBump_[jgrid], atlasFieldSet->get());
-  }
-  dxo.fromAtlas(atlasFieldSet.get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dxi);
+  dxi.toAtlas(atlasFieldSet);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_apply_vbal_inv_ad_f90(keyOoBump, impls[0]);
+  });
+  dxo.fromAtlas(atlasFieldSet);
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::multiplyStdDev(const Increment_ & dxi, Increment_ & dxo) const {
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dxi.toAtlas(atlasFieldSet.get());
-  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_apply_stddev_f90(keyOoBump_[jgrid], atlasFieldSet->get());
-  }
-  dxo.fromAtlas(atlasFieldSet.get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dxi);
+  dxi.toAtlas(atlasFieldSet);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_apply_stddev_f90(keyOoBump, impls[0]);
+  });
+  dxo.fromAtlas(atlasFieldSet);
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::multiplyStdDevInv(const Increment_ & dxi, Increment_ & dxo) const {
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dxi.toAtlas(atlasFieldSet.get());
-  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_apply_stddev_inv_f90(keyOoBump_[jgrid], atlasFieldSet->get());
-  }
-  dxo.fromAtlas(atlasFieldSet.get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dxi);
+  dxi.toAtlas(atlasFieldSet);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_apply_stddev_inv_f90(keyOoBump, impls[0]);
+  });
+  dxo.fromAtlas(atlasFieldSet);
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::multiplyNicas(Increment_ & dx) const {
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dx.toAtlas(atlasFieldSet.get());
-  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_apply_nicas_f90(keyOoBump_[jgrid], atlasFieldSet->get());
-  }
-  dx.fromAtlas(atlasFieldSet.get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dx);
+  dx.toAtlas(atlasFieldSet);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_apply_nicas_f90(keyOoBump, impls[0]);
+  });
+  dx.fromAtlas(atlasFieldSet);
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::multiplyNicas(const Increment_ & dxi, Increment_ & dxo) const {
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dxi.toAtlas(atlasFieldSet.get());
-  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_apply_nicas_f90(keyOoBump_[jgrid], atlasFieldSet->get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dxi);
+  dxi.toAtlas(atlasFieldSet);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_apply_nicas_f90(keyOoBump, impls[0]);
+  });
+  dxo.fromAtlas(atlasFieldSet);
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+void OoBump<MODEL>::multiplyNicas(std::vector<Increment_> & dxs) const {
+  // All increments are processed in a single NICAS pass, with aggregated halo communications
+  const int nf = dxs.size();
+  std::vector<atlas::FieldSet *> atlasFieldSets;
+  for (int jf = 0; jf < nf; ++jf) {
+    atlasFieldSets.push_back(getFieldSet(dxs[jf], jf));
+    dxs[jf].toAtlas(atlasFieldSets[jf]);
+  }
+  applyGrids(atlasFieldSets, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_apply_nicas_batch_f90(keyOoBump, nf, impls.data());
+  });
+  for (int jf = 0; jf < nf; ++jf) {
+    dxs[jf].fromAtlas(atlasFieldSets[jf]);
   }
-  dxo.fromAtlas(atlasFieldSet.get());
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::inverseMultiplyNicas(const Increment_ & dxi, Increment_ & dxo) const {
-  oops::IdentityMatrix<Increment_> Id;
+  // The NICAS diagonal is cheap to invert and is exact up to the normalization accuracy
+  NicasDiagInv Dinv(*this);
   dxo.zero();
-  GMRESR(dxo, dxi, *this, Id, 10, 1.0e-3);
+  nmultiply_ = 0;
+  const auto start = std::chrono::steady_clock::now();
+  double reduc = 0.0;
+  if (inverseSolver_ == "pcg") {
+    // NICAS is symmetric positive definite
+    reduc = PCG(dxo, dxi, *this, Dinv, inverseNiter_, inverseTolerance_);
+  } else if (inverseSolver_ == "gmresr") {
+    reduc = GMRESR(dxo, dxi, *this, Dinv, inverseNiter_, inverseTolerance_);
+  } else {
+    ABORT("OoBump: wrong inverse_solver " + inverseSolver_ + ", should be pcg or gmresr");
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()-start;
+  oops::Log::info() << "OoBump::inverseMultiplyNicas: " << inverseSolver_ << " reduction "
+                    << reduc << " after " << nmultiply_ << " NICAS applications in "
+                    << elapsed.count() << " s" << std::endl;
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+void OoBump<MODEL>::multiplyNicasDiagInv(const Increment_ & dxi, Increment_ & dxo) const {
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dxi);
+  dxi.toAtlas(atlasFieldSet);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_apply_nicas_diag_inv_f90(keyOoBump, impls[0]);
+  });
+  dxo.fromAtlas(atlasFieldSet);
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::randomize(Increment_ & dx) const {
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dx.setAtlas(atlasFieldSet.get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dx);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_randomize_f90(keyOoBump, impls[0]);
+  });
+  dx.fromAtlas(atlasFieldSet);
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+void OoBump<MODEL>::appendObs(const std::vector<double> & lonobs,
+                              const std::vector<double> & latobs) const {
+  ASSERT(lonobs.size() == latobs.size());
+  const int nobs = lonobs.size();
+  std::shared_lock<std::shared_timed_mutex> lock(bumpMutex());
   for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_randomize_f90(keyOoBump_[jgrid], atlasFieldSet->get());
+    bump_append_obs_f90(keyOoBump_[jgrid], nobs, lonobs.data(), latobs.data());
+  }
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+void OoBump<MODEL>::removeObs(const std::vector<bool> & remove) const {
+  const int nobs = remove.size();
+  std::vector<int> maskRm(remove.begin(), remove.end());
+  std::shared_lock<std::shared_timed_mutex> lock(bumpMutex());
+  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
+    bump_remove_obs_f90(keyOoBump_[jgrid], nobs, maskRm.data());
   }
-  dx.fromAtlas(atlasFieldSet.get());
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::getParameter(const std::string & param, Increment_ & dx) const {
   const int nstr = param.size();
   const char *cstr = param.c_str();
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dx.setAtlas(atlasFieldSet.get());
-  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_get_parameter_f90(keyOoBump_[jgrid], nstr, cstr, atlasFieldSet->get());
-  }
-  dx.fromAtlas(atlasFieldSet.get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dx);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_get_parameter_f90(keyOoBump, nstr, cstr, impls[0]);
+  });
+  dx.fromAtlas(atlasFieldSet);
 }
 // -----------------------------------------------------------------------------
 template<typename MODEL>
 void OoBump<MODEL>::setParameter(const std::string & param, const Increment_ & dx) const {
   const int nstr = param.size();
   const char *cstr = param.c_str();
-  std::unique_ptr<atlas::FieldSet> atlasFieldSet(new atlas::FieldSet());
-  dx.toAtlas(atlasFieldSet.get());
-  for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
-    bump_set_parameter_f90(keyOoBump_[jgrid], nstr, cstr, atlasFieldSet->get());
+  atlas::FieldSet * atlasFieldSet = getFieldSet(dx);
+  dx.toAtlas(atlasFieldSet);
+  applyGrids({atlasFieldSet}, [&](const int & keyOoBump, const FieldSetImpls_ & impls) {
+    bump_set_parameter_f90(keyOoBump, nstr, cstr, impls[0]);
+  });
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+atlas::FieldSet * OoBump<MODEL>::getFieldSet(const Increment_ & dx, const size_t & jf) const {
+  // The FieldSet buffers are keyed by the increment variables and the batch index. Each one is
+  // allocated at its first use and reused by all further calls with the same variables: toAtlas
+  // then copies into the existing fields and fromAtlas copies back from them, without any
+  // allocation. Output-only calls (randomize, getParameter) never see fields of other variables.
+  std::string vars;
+  for (unsigned int jvar = 0; jvar < dx.variables().size(); ++jvar) {
+    vars += dx.variables()[jvar] + ",";
+  }
+  std::unique_ptr<atlas::FieldSet> & atlasFieldSet = atlasFieldSets_[std::make_pair(vars, jf)];
+  if (!atlasFieldSet) {
+    atlasFieldSet.reset(new atlas::FieldSet());
+    dx.setAtlas(atlasFieldSet.get());
+  }
+  return atlasFieldSet.get();
+}
+// -----------------------------------------------------------------------------
+template<typename MODEL>
+template<typename FUNC>
+void OoBump<MODEL>::applyGrids(const std::vector<atlas::FieldSet *> & atlasFieldSets,
+                               const FUNC & apply) const {
+  std::shared_lock<std::shared_timed_mutex> lock(bumpMutex());
+  if (nthreads_.empty()) {
+    // Sequential application
+    FieldSetImpls_ impls;
+    for (const auto & atlasFieldSet : atlasFieldSets) impls.push_back(atlasFieldSet->get());
+    for (unsigned int jgrid = 0; jgrid < keyOoBump_.size(); ++jgrid) {
+      apply(keyOoBump_[jgrid], impls);
+    }
+  } else {
+    // Concurrent application, each grid gets its own FieldSets, holding the fields of its own
+    // variables only (the fields are shared, not copied)
+    const unsigned int ngrid = keyOoBump_.size();
+    std::vector<std::vector<atlas::FieldSet>> gridFieldSets(ngrid);
+    std::vector<FieldSetImpls_> gridImpls(ngrid);
+    for (unsigned int jgrid = 0; jgrid < ngrid; ++jgrid) {
+      for (const auto & atlasFieldSet : atlasFieldSets) {
+        atlas::FieldSet gridFieldSet;
+        for (const auto & var : gridVars_[jgrid]) {
+          if (atlasFieldSet->has_field(var)) gridFieldSet.add(atlasFieldSet->field(var));
+        }
+        gridFieldSets[jgrid].push_back(gridFieldSet);
+        gridImpls[jgrid].push_back(gridFieldSet.get());
+      }
+    }
+
+    // Exceptions are captured in each thread and rethrown once all threads are joined
+    int nthreadsTot = 1;
+    bump_get_max_threads_f90(nthreadsTot);
+    std::vector<std::exception_ptr> errors(ngrid);
+    std::vector<std::thread> threads;
+    for (unsigned int jgrid = 1; jgrid < ngrid; ++jgrid) {
+      threads.emplace_back([&, jgrid]() {
+        try {
+          bump_set_num_threads_f90(nthreads_[jgrid]);
+          apply(keyOoBump_[jgrid], gridImpls[jgrid]);
+        } catch (...) {
+          errors[jgrid] = std::current_exception();
+        }
+      });
+    }
+    try {
+      bump_set_num_threads_f90(nthreads_[0]);
+      apply(keyOoBump_[0], gridImpls[0]);
+    } catch (...) {
+      errors[0] = std::current_exception();
+    }
+    for (auto & thread : threads) thread.join();
+    bump_set_num_threads_f90(nthreadsTot);
+    for (const auto & error : errors) {
+      if (error) std::rethrow_exception(error);
+    }
   }
 }
 // -----------------------------------------------------------------------------
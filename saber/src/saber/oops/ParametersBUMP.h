@@ -8,10 +8,15 @@
 #ifndef SABER_OOPS_PARAMETERSBUMP_H_
 #define SABER_OOPS_PARAMETERSBUMP_H_
 
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "eckit/config/Configuration.h"
@@ -54,13 +59,16 @@ class ParametersBUMP {
                  const util::DateTime &,
                  const eckit::Configuration &,
                  const EnsemblePtr_ ens1 = NULL,
-                 const EnsemblePtr_ ens2 = NULL);
+                 const EnsemblePtr_ ens2 = NULL,
+                 const bool runDrivers = true);
   ~ParametersBUMP();
 
   OoBump_ & getOoBump() {return *ooBump_;}
   void write() const;
 
  private:
+  void addMembers(const EnsemblePtr_, const int &) const;
+
   const Geometry_ resol_;
   const oops::Variables vars_;
   util::DateTime time_;
@@ -76,7 +84,8 @@ ParametersBUMP<MODEL>::ParametersBUMP(const Geometry_ & resol,
                                       const util::DateTime & time,
                                       const eckit::Configuration & conf,
                                       const EnsemblePtr_ ens1,
-                                      const EnsemblePtr_ ens2)
+                                      const EnsemblePtr_ ens2,
+                                      const bool runDrivers)
   : resol_(resol), vars_(vars), time_(time), conf_(conf), ooBump_()
 {
   oops::Log::trace() << "ParametersBUMP<MODEL>::ParametersBUMP construction starting" << std::endl;
@@ -108,19 +117,13 @@ ParametersBUMP<MODEL>::ParametersBUMP(const Geometry_ & resol,
   // Add members of ensemble 1
   if (ens1) {
     oops::Log::info() << "--- Add members of ensemble 1" << std::endl;
-    for (int ie = 0; ie < ens1_ne; ++ie) {
-      oops::Log::info() << "      Member " << ie+1 << " / " << ens1_ne << std::endl;
-      ooBump_->addMember((*ens1)[ie].atlas(), ie, 1);
-    }
+    addMembers(ens1, 1);
   }
 
   // Add members of ensemble 2
   if (ens2) {
     oops::Log::info() << "--- Add members of ensemble 2" << std::endl;
-    for (int ie = 0; ie < ens2_ne; ++ie) {
-      oops::Log::info() << "      Member " << ie+1 << " / " << ens2_ne << std::endl;
-      ooBump_->addMember((*ens2)[ie].atlas(), ie, 2);
-    }
+    addMembers(ens2, 2);
   }
 
   // Read data from files
@@ -144,8 +147,8 @@ ParametersBUMP<MODEL>::ParametersBUMP(const Geometry_ & resol,
     }
   }
 
-  // Estimate parameters
-  ooBump_->runDrivers();
+  // Estimate parameters (unless the caller runs the drivers itself)
+  if (runDrivers) ooBump_->runDrivers();
 
   oops::Log::trace() << "ParametersBUMP:ParametersBUMP constructed" << std::endl;
 }
@@ -161,6 +164,80 @@ ParametersBUMP<MODEL>::~ParametersBUMP() {
 
 // -----------------------------------------------------------------------------
 
+template<typename MODEL>
+void ParametersBUMP<MODEL>::addMembers(const EnsemblePtr_ ens, const int & iens) const {
+  // Members are converted to ATLAS (producer) and added to BUMP by batches (consumer). In
+  // asynchronous mode, the conversion runs on a separate thread and overlaps with the ingestion
+  // of the previous batches (the model toAtlas must then be thread-safe).
+  const int ne = ens->size();
+  const int batchSize = std::max(1, conf_.getInt("members batch size", ne));
+  const bool async = conf_.getBool("asynchronous members", false);
+
+  // Producer, its exceptions are captured and rethrown after join
+  int nready = 0;
+  bool stop = false;
+  std::exception_ptr producerError;
+  std::mutex mtx;
+  std::condition_variable cv;
+  auto produce = [&]() {
+    try {
+      for (int ie = 0; ie < ne; ++ie) {
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          if (stop) break;
+        }
+        (*ens)[ie].toAtlas();
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          ++nready;
+        }
+        cv.notify_one();
+      }
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        producerError = std::current_exception();
+      }
+      cv.notify_one();
+    }
+  };
+  std::thread producer;
+  if (async) {
+    producer = std::thread(produce);
+  } else {
+    produce();
+  }
+
+  // Consumer, the producer is stopped and joined if it fails
+  std::exception_ptr consumerError;
+  try {
+    for (int ie = 0; ie < ne; ie += batchSize) {
+      const int nmem = std::min(batchSize, ne-ie);
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&] {return producerError || nready >= ie+nmem;});
+        if (producerError) break;
+      }
+      oops::Log::info() << "      Members " << ie+1 << " to " << ie+nmem << " / " << ne
+                        << std::endl;
+      std::vector<atlas::FieldSet> atlasFieldSets;
+      std::vector<const atlas::FieldSet *> atlasFieldSetPtrs;
+      for (int jmem = 0; jmem < nmem; ++jmem) atlasFieldSets.push_back((*ens)[ie+jmem].atlas());
+      for (int jmem = 0; jmem < nmem; ++jmem) atlasFieldSetPtrs.push_back(&atlasFieldSets[jmem]);
+      ooBump_->addMembers(atlasFieldSetPtrs, ie, iens);
+    }
+  } catch (...) {
+    consumerError = std::current_exception();
+    std::lock_guard<std::mutex> lock(mtx);
+    stop = true;
+  }
+  if (producer.joinable()) producer.join();
+  if (producerError) std::rethrow_exception(producerError);
+  if (consumerError) std::rethrow_exception(consumerError);
+}
+
+// -----------------------------------------------------------------------------
+
 template<typename MODEL>
 void ParametersBUMP<MODEL>::write() const {
   oops::Log::trace() << "ParametersBUMP::write starting" << std::endl;
@@ -20,6 +20,7 @@
 #include "oops/interface/Increment.h"
 #include "oops/interface/State.h"
 
+#include "saber/oops/LazyOoBump.h"
 #include "saber/oops/OoBump.h"
 #include "saber/oops/ParametersBUMP.h"
 
@@ -41,6 +42,7 @@ template <typename MODEL>
 class StatsVariableChange : public oops::LinearVariableChangeBase<MODEL> {
   typedef oops::Geometry<MODEL>  Geometry_;
   typedef oops::Increment<MODEL> Increment_;
+  typedef LazyOoBump<MODEL>      LazyOoBump_;
   typedef OoBump<MODEL>          OoBump_;
   typedef oops::State<MODEL>     State_;
   typedef ParametersBUMP<MODEL>  ParametersBUMP_;
@@ -69,7 +71,7 @@ class StatsVariableChange : public oops::LinearVariableChangeBase<MODEL> {
                      std::vector<std::string>& modelVarToCalcList,
                      std::vector<std::string>& varRegrByList);
 
-  std::unique_ptr<OoBump_> ooBump_;
+  LazyOoBump_ ooBump_;
 
   // StatsVarData populate(const varin_ , const varout_, const eckit::Configuration);
 };
@@ -85,11 +87,8 @@ StatsVariableChange<MODEL>::StatsVariableChange(const State_ & xb, const State_
 // Setup variables
   const oops::Variables vars(conf, "input variables");
 
-// Setup parameters
-  ParametersBUMP_ param(resol, vars, xb.validTime(), conf);
-
-// Transfer OoBump pointer
-  ooBump_.reset(new OoBump_(param.getOoBump()));
+// Setup parameters and OoBump, possibly in the background
+  ooBump_.build(resol, vars, xb.validTime(), conf);
 
   oops::Log::trace() << "StatsVariableChange<MODEL>::StatsVariableChange done" << std::endl;
 }
@@ -0,0 +1,38 @@
+/*
+ * (C) Copyright 2017 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+void *mmap_open(const char *filename, int64_t *size)
+{
+  int fd;
+  struct stat st;
+  void *ptr;
+  *size = 0;
+  fd = open(filename, O_RDONLY);
+  if (fd < 0) return NULL;
+  if ((fstat(fd, &st) != 0) || (st.st_size == 0)) {
+    close(fd);
+    return NULL;
+  }
+  ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) return NULL;
+  madvise(ptr, (size_t)st.st_size, MADV_SEQUENTIAL);
+  *size = (int64_t)st.st_size;
+  return ptr;
+}
+
+int32_t mmap_close(void *ptr, int64_t *size)
+{
+  return (int32_t)munmap(ptr, (size_t)*size);
+}
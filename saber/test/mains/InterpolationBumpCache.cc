@@ -0,0 +1,129 @@
+/*
+ * (C) Copyright 2021- UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "atlas/array.h"
+#include "atlas/field.h"
+#include "atlas/functionspace.h"
+#include "atlas/grid.h"
+#include "atlas/util/Constants.h"
+#include "eckit/config/Configuration.h"
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/mpi/Comm.h"
+
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Application.h"
+#include "oops/runs/Run.h"
+#include "oops/util/Logger.h"
+
+#include "saber/interpolation/InterpolatorBump.h"
+
+namespace saber {
+
+// -----------------------------------------------------------------------------
+/// Construct the BUMP interpolator three times on the same grids: without any cached weights,
+/// with the weights in the memory cache, then with the memory cache off so that the weights are
+/// read from the disk cache. The three interpolated fields should be identical.
+
+class InterpolationBumpCache : public oops::Application {
+ public:
+  explicit InterpolationBumpCache(const eckit::mpi::Comm & comm = oops::mpi::world())
+    : Application(comm) {}
+
+  int execute(const eckit::Configuration & fullConfig) const {
+    const eckit::LocalConfiguration conf(fullConfig, "test_interpolation_cache");
+    const eckit::LocalConfiguration memConf(conf, "interpolator");
+    const size_t nlev = memConf.getInt("nlevels");
+
+    // Grids and function spaces
+    const atlas::StructuredGrid ingrid(conf.getString("input grid"));
+    const atlas::StructuredGrid outgrid(conf.getString("output grid"));
+    atlas::functionspace::StructuredColumns infspace(ingrid, atlas::option::levels(nlev));
+    atlas::functionspace::StructuredColumns outfspace(outgrid, atlas::option::levels(nlev));
+
+    // Input field: smooth analytic function
+    atlas::Field infield = infspace.createField<double>(atlas::option::name("var")
+                                                       | atlas::option::levels(nlev));
+    auto inview = atlas::array::make_view<double, 2>(infield);
+    auto lonlat = atlas::array::make_view<double, 2>(infspace.xy());
+    for (atlas::idx_t jnode = 0; jnode < infspace.size_owned(); ++jnode) {
+      const double lon = lonlat(jnode, 0)*atlas::util::Constants::degreesToRadians();
+      const double lat = lonlat(jnode, 1)*atlas::util::Constants::degreesToRadians();
+      for (size_t jlev = 0; jlev < nlev; ++jlev) {
+        inview(jnode, jlev) = std::cos(lat)*std::cos(lon)+static_cast<double>(jlev);
+      }
+    }
+
+    // Configurations: memory and disk cache, then disk cache only
+    eckit::LocalConfiguration diskConf(memConf);
+    eckit::LocalConfiguration bumpConf(diskConf, "bump");
+    bumpConf.set("interp_cache", false);
+    diskConf.set("bump", bumpConf);
+    ASSERT(bumpConf.has("cachedir"));
+
+    // Interpolate with cold cache, memory cache and disk cache
+    atlas::Field outref = interpolate(memConf, infspace, outfspace, infield, nlev);
+    atlas::Field outmem = interpolate(memConf, infspace, outfspace, infield, nlev);
+    atlas::Field outdisk = interpolate(diskConf, infspace, outfspace, infield, nlev);
+
+    // Compare
+    const double diffmem = maxdiff(outfspace, outref, outmem, nlev);
+    const double diffdisk = maxdiff(outfspace, outref, outdisk, nlev);
+    oops::Log::test() << "Interpolation with the memory cache, maximum difference: " << diffmem
+                      << std::endl;
+    oops::Log::test() << "Interpolation with the disk cache, maximum difference: " << diffdisk
+                      << std::endl;
+    ASSERT(diffmem == 0.0);
+    ASSERT(diffdisk == 0.0);
+    return 0;
+  }
+
+ private:
+  atlas::Field interpolate(const eckit::Configuration & interpConf,
+                           const atlas::functionspace::StructuredColumns & infspace,
+                           const atlas::functionspace::StructuredColumns & outfspace,
+                           const atlas::Field & infield, const size_t nlev) const {
+    InterpolatorBump interp(interpConf, infspace, outfspace, nullptr, this->getComm());
+    atlas::Field outfield = outfspace.createField<double>(atlas::option::name("var")
+                                                         | atlas::option::levels(nlev));
+    interp.apply(infield, outfield);
+    return outfield;
+  }
+
+  double maxdiff(const atlas::functionspace::StructuredColumns & fspace,
+                 const atlas::Field & field1, const atlas::Field & field2,
+                 const size_t nlev) const {
+    auto view1 = atlas::array::make_view<double, 2>(field1);
+    auto view2 = atlas::array::make_view<double, 2>(field2);
+    double diff = 0.0;
+    for (atlas::idx_t jnode = 0; jnode < fspace.size_owned(); ++jnode) {
+      for (size_t jlev = 0; jlev < nlev; ++jlev) {
+        diff = std::max(diff, std::abs(view1(jnode, jlev)-view2(jnode, jlev)));
+      }
+    }
+    this->getComm().allReduceInPlace(diff, eckit::mpi::max());
+    return diff;
+  }
+
+  std::string appname() const {
+    return "saber::InterpolationBumpCache";
+  }
+};
+
+}  // namespace saber
+
+// -----------------------------------------------------------------------------
+
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  saber::InterpolationBumpCache tests;
+  return run.execute(tests);
+}
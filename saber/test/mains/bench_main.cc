@@ -0,0 +1,27 @@
+/*!----------------------------------------------------------------------
+ main: bench_main
+ Purpose: command line arguments parsing and call to the BUMP benchmark
+ Author: Benjamin Menetrier
+ Licensing: this code is distributed under the CeCILL-C license
+ Copyright © 2015-... UCAR, CERFACS, METEO-FRANCE and IRIT
+----------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "eckit/runtime/Main.h"
+
+extern "C" {
+  void bench_main_f90(const int &, const char *, const int &, const char *, const int &);
+}
+
+int main(int argc, char** argv) {
+  if ((argc != 3) && (argc != 4)) return 1;
+  eckit::Main::initialise(argc, argv);
+  int n1 = strlen(argv[1]);
+  int n2 = strlen(argv[2]);
+  int nrep = 10;
+  if (argc == 4) nrep = atoi(argv[3]);
+  bench_main_f90(n1, argv[1], n2, argv[2], nrep);
+  return 0;
+}
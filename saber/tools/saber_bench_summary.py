@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+#----------------------------------------------------------------------
+# Python script: saber_bench_summary
+# Author: Benjamin Menetrier
+# Licensing: this code is distributed under the CeCILL-C license
+# Copyright © 2015-... UCAR, CERFACS, METEO-FRANCE and IRIT
+#----------------------------------------------------------------------
+
+# Gather the kernels timings written by saber_bench.x into a single JSON file for trend tracking:
+# saber_bench_summary.py <testoutput directory> <output JSON file>
+# Each benchmark run (<benchmark>/test_<tasks>-<threads>_bench.json) gives one entry, with the time per call of
+# each kernel on the slowest task and its imbalance between tasks.
+
+import glob
+import json
+import os
+import sys
+
+if len(sys.argv) != 3:
+   sys.exit("usage: saber_bench_summary.py <testoutput directory> <output JSON file>")
+
+runs = []
+for filename in sorted(glob.glob(os.path.join(sys.argv[1], "bench_*", "*_bench.json"))):
+   # Read benchmark run
+   with open(filename) as f:
+      stats = json.load(f)
+   kernels = {}
+   for region in stats["regions"]:
+      ncall = max(region["calls"], 1)
+      kernels[region["path"]] = {"calls": region["calls"], "time_per_call": region["task_max"]/ncall, \
+         "task_imbalance": region["task_imbalance"], "thread_imbalance": region["thread_imbalance"]}
+   runs.append({"benchmark": os.path.basename(os.path.dirname(filename)), "nproc": stats["nproc"], \
+      "nthread": stats["nthread"], "kernels": kernels})
+
+if len(runs) == 0:
+   sys.exit("no benchmark results found in " + sys.argv[1])
+
+# Write summary
+with open(sys.argv[2], "w") as f:
+   json.dump({"runs": runs}, f, indent=2)
+
+# Print summary
+print("{:<24} {:>6} {:>8} {:<20} {:>14} {:>8}".format("benchmark", "tasks", "threads", "kernel", "time/call (s)", \
+   "imb."))
+for run in runs:
+   for name, kernel in run["kernels"].items():
+      print("{:<24} {:>6d} {:>8d} {:<20} {:>14.6f} {:>8.2f}".format(run["benchmark"], run["nproc"], run["nthread"], \
+         name, kernel["time_per_call"], kernel["task_imbalance"]))
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+#----------------------------------------------------------------------
+# Python script: saber_comm_check
+# Author: Benjamin Menetrier
+# Licensing: this code is distributed under the CeCILL-C license
+# Copyright © 2015-... UCAR, CERFACS, METEO-FRANCE and IRIT
+#----------------------------------------------------------------------
+
+# Check the communication statistics written by BUMP ('comm_stats' key):
+# saber_comm_check.py <prefix>_comm.json <operator> [<operator> ...]
+# The test fails if a required operator is missing, or if the statistics of an operator are inconsistent (no call,
+# negative value, minimum larger than the mean or mean larger than the maximum, wrong matrix shape, negative matrix
+# entry, matrix total larger than the bytes sent).
+
+import json
+import sys
+
+if len(sys.argv) < 3:
+   sys.exit("usage: saber_comm_check.py <prefix>_comm.json <operator> [<operator> ...]")
+eps = 1.0e-6
+
+# Read statistics
+with open(sys.argv[1]) as f:
+   stats = json.load(f)
+nproc = stats["nproc"]
+if nproc < 1:
+   sys.exit("\033[31mWrong number of tasks\033[0m")
+operators = {op["name"]: op for op in stats["operators"]}
+
+# Check required operators
+status = 0
+for name in sys.argv[2:]:
+   if name not in operators:
+      print("{:<30} missing".format(name))
+      status = 1
+
+# Check statistics
+for name, op in sorted(operators.items()):
+   errors = []
+   if op["calls"] < 1:
+      errors.append("no call")
+   for kind in ["bytes_sent", "bytes_recv", "messages", "peers", "time"]:
+      vmin, vmean, vmax = op[kind + "_min"], op[kind + "_mean"], op[kind + "_max"]
+      if vmin < 0.0:
+         errors.append(kind + " negative")
+      if (vmin > vmean*(1.0+eps)+eps) or (vmean > vmax*(1.0+eps)+eps):
+         errors.append(kind + " min/mean/max inconsistent")
+   if op["peers_max"] > nproc:
+      errors.append("more peers than tasks")
+   matrix = op["matrix"]
+   if len(matrix) != nproc or any(len(row) != nproc for row in matrix):
+      errors.append("wrong matrix shape")
+   else:
+      if any(v < 0 for row in matrix for v in row):
+         errors.append("negative matrix entry")
+      if sum(sum(row) for row in matrix) > op["bytes_sent_mean"]*nproc*(1.0+eps)+1.0:
+         errors.append("matrix total larger than bytes sent")
+   print("{:<30} {:>8} {:>14.0f}  {}".format(name, op["calls"], op["bytes_sent_max"], ", ".join(errors)))
+   if len(errors) > 0:
+      status = 1
+
+if status == 0:
+   print("Communication statistics consistent")
+else:
+   print("\033[31mCommunication statistics missing or inconsistent\033[0m")
+sys.exit(status)
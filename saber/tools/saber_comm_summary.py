@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+#----------------------------------------------------------------------
+# Python script: saber_comm_summary
+# Author: Benjamin Menetrier
+# Licensing: this code is distributed under the CeCILL-C license
+# Copyright © 2015-... UCAR, CERFACS, METEO-FRANCE and IRIT
+#----------------------------------------------------------------------
+
+# Summarize the communication statistics written by BUMP ('comm_stats' key):
+# saber_comm_summary.py <prefix>_comm.json [operator]
+# Without operator: one line per operator with volumes, messages, peers and time.
+# With operator: communication matrix of this operator, in bytes (row: sending task).
+
+import json
+import sys
+
+if len(sys.argv) < 2:
+   sys.exit("usage: saber_comm_summary.py <prefix>_comm.json [operator]")
+
+# Read statistics
+with open(sys.argv[1]) as f:
+   stats = json.load(f)
+nproc = stats["nproc"]
+
+def imbalance(vmax, vmean):
+   return vmax/vmean if vmean > 0.0 else 1.0
+
+if len(sys.argv) < 3:
+   # Operators summary
+   print("Communication statistics over " + str(nproc) + " MPI tasks")
+   print("{:<20} {:>8} {:>12} {:>12} {:>8} {:>10} {:>10} {:>10} {:>8}".format("operator", "calls", \
+      "MB/call", "MB max/call", "imb.", "msg/call", "peers max", "time (s)", "imb."))
+   for op in stats["operators"]:
+      ncall = max(op["calls"], 1)
+      print("{:<20} {:>8d} {:>12.4f} {:>12.4f} {:>8.2f} {:>10.1f} {:>10.0f} {:>10.4f} {:>8.2f}".format(op["name"], \
+         op["calls"], op["bytes_sent_mean"]/ncall*1.0e-6, op["bytes_sent_max"]/ncall*1.0e-6, \
+         imbalance(op["bytes_sent_max"], op["bytes_sent_mean"]), op["messages_mean"]/ncall, op["peers_max"], \
+         op["time_mean"], imbalance(op["time_max"], op["time_mean"])))
+else:
+   # Communication matrix
+   ops = [op for op in stats["operators"] if op["name"] == sys.argv[2]]
+   if len(ops) == 0:
+      sys.exit("operator " + sys.argv[2] + " not found")
+   matrix = ops[0]["matrix"]
+   print("Communication matrix of " + sys.argv[2] + " (bytes, row: sending task, column: receiving task)")
+   print("{:>6} ".format("") + " ".join(["{:>10d}".format(jproc+1) for jproc in range(nproc)]))
+   for iproc in range(nproc):
+      print("{:>6d} ".format(iproc+1) + " ".join(["{:>10d}".format(v) for v in matrix[iproc]]))
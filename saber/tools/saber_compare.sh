@@ -102,14 +102,15 @@ if test "${test%%_*}" = "bump" ; then
          fi
       done
    else
-      # Specific tests
+      # Specific tests (optional fifth argument: MPI-OpenMP layout of the second test)
       test2=$2
       mpiomp=$3
       suffix=$4
+      mpiomp2=${5:-${mpiomp}}
       
       # Build file names
       file=testdata/${test}/test_${mpiomp}_${suffix}.nc
-      file2=testdata/${test2}/test_${mpiomp}_${suffix}.nc
+      file2=testdata/${test2}/test_${mpiomp2}_${suffix}.nc
 
       # Compare files with NCCMP
       if [ -x "$(command -v nccmp)" ] ; then
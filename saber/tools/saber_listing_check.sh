@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+#----------------------------------------------------------------------
+# Bash script: saber_listing_check
+# Author: Benjamin Menetrier
+# Licensing: this code is distributed under the CeCILL-C license
+# Copyright © 2015-... UCAR, CERFACS, METEO-FRANCE and IRIT
+#----------------------------------------------------------------------
+
+# Reset a directory (cache or output directory):
+# saber_listing_check.sh --clean <directory>
+# Check that a listing contains the expected messages:
+# saber_listing_check.sh <listing> <message> [<message> ...]
+
+if test "$1" = "--clean" ; then
+   # Reset directory
+   rm -fr $2
+   mkdir -p $2
+   exit $?
+fi
+
+if test $# -lt 2 ; then
+   echo "usage: saber_listing_check.sh <listing> <message> [<message> ...]"
+   exit 1
+fi
+
+# Parameters
+listing=$1
+shift
+
+# Initialize exit status
+status=0
+
+# Check listing
+if test ! -f ${listing} ; then
+   echo -e "\e[31mNo log file to check: ${listing}\e[0m"
+   exit 2
+fi
+
+# Check messages
+for message in "$@" ; do
+   if grep -qF -- "${message}" ${listing} ; then
+      echo -e "Found: ${message}"
+   else
+      echo -e "\e[31mMissing: ${message}\e[0m"
+      status=3
+   fi
+done
+
+# Exit
+exit ${status}
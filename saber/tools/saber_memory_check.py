@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+#----------------------------------------------------------------------
+# Python script: saber_memory_check
+# Author: Benjamin Menetrier
+# Licensing: this code is distributed under the CeCILL-C license
+# Copyright © 2015-... UCAR, CERFACS, METEO-FRANCE and IRIT
+#----------------------------------------------------------------------
+
+# Check the memory reports written by BUMP in its listing ('mem_estimate' and 'mem_stats' keys):
+# saber_memory_check.py <listing> <stage> [<stage> ...]
+# The test fails if the memory estimate or the report of a required stage is missing, if a value is negative or not
+# readable, if the peak is below the resident memory, or if the estimated total is not positive.
+
+import re
+import sys
+
+if len(sys.argv) < 3:
+   sys.exit("usage: saber_memory_check.py <listing> <stage> [<stage> ...]")
+
+# Read listing
+with open(sys.argv[1]) as f:
+   lines = f.read().splitlines()
+
+def values(line):
+   return [float(v) if re.match(r"^-?[0-9.]+$", v) else -1.0 for v in re.findall(r"(\S+) MB", line)]
+
+status = 0
+
+# Memory estimate
+estimate = [i for i, line in enumerate(lines) if "Memory estimate per task" in line]
+if len(estimate) == 0:
+   print("memory estimate missing")
+   status = 1
+else:
+   total = None
+   for line in lines[estimate[0]+1:]:
+      if " MB" not in line:
+         break
+      if any(v < 0.0 for v in values(line)):
+         print("memory estimate wrong value: " + line.strip())
+         status = 1
+      if "Total:" in line:
+         total = values(line)[0]
+         break
+   if total is None or total <= 0.0:
+      print("memory estimate total missing or not positive")
+      status = 1
+   else:
+      print("{:<30} {:>12.1f} MB".format("estimate", total))
+
+# Memory reports
+for stage in sys.argv[2:]:
+   report = [i for i, line in enumerate(lines) if "Memory after stage " + stage + " " in line]
+   if len(report) == 0:
+      print("{:<30} missing".format(stage))
+      status = 1
+      continue
+   usage = values(lines[report[0]+1])
+   if len(usage) != 3 or any(v < 0.0 for v in usage) or usage[1] < usage[0]:
+      print("{:<30} wrong usage: {}".format(stage, lines[report[0]+1].strip()))
+      status = 1
+      continue
+   for line in lines[report[0]+2:]:
+      if " MB" not in line or "Memory" in line:
+         break
+      if any(v < 0.0 for v in values(line)):
+         print("{:<30} wrong footprint: {}".format(stage, line.strip()))
+         status = 1
+   print("{:<30} {:>12.1f} MB {:>12.1f} MB".format(stage, usage[0], usage[1]))
+
+if status == 0:
+   print("Memory reports consistent")
+else:
+   print("\033[31mMemory reports missing or inconsistent\033[0m")
+sys.exit(status)
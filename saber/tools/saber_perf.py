@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+#----------------------------------------------------------------------
+# Python script: saber_perf
+# Author: Benjamin Menetrier
+# Licensing: this code is distributed under the CeCILL-C license
+# Copyright © 2015-... UCAR, CERFACS, METEO-FRANCE and IRIT
+#----------------------------------------------------------------------
+
+# Compare the regions timing written by BUMP ('timing' key) with a stored baseline:
+# saber_perf.py <prefix>_timing.json <baseline JSON> <tolerance> [minimum time (s)]
+# The test fails if a baseline region is missing, or if its time on the slowest task exceeds the baseline time by more
+# than the relative tolerance and by more than the minimum time (to ignore timer noise on short regions). If the
+# baseline does not exist, the test is skipped (exit code 77).
+# Record a baseline from the current timing (driver stages, i.e. top-level regions, and all regions longer than the
+# minimum time):
+# saber_perf.py --record <prefix>_timing.json <baseline JSON> [minimum time (s)]
+
+import json
+import os
+import socket
+import sys
+
+skip_code = 77
+record = (len(sys.argv) > 1) and (sys.argv[1] == "--record")
+args = sys.argv[2:] if record else sys.argv[1:]
+if record and (len(args) < 2):
+   sys.exit("usage: saber_perf.py --record <prefix>_timing.json <baseline JSON> [minimum time (s)]")
+if (not record) and (len(args) < 3):
+   sys.exit("usage: saber_perf.py <prefix>_timing.json <baseline JSON> <tolerance> [minimum time (s)]")
+if record:
+   tmin = float(args[2]) if len(args) > 2 else 0.05
+else:
+   tolerance = float(args[2])
+   tmin = float(args[3]) if len(args) > 3 else 0.05
+
+# Read current timing
+with open(args[0]) as f:
+   stats = json.load(f)
+current = {region["path"]: region["task_max"] for region in stats["regions"]}
+
+if record:
+   # Record baseline
+   regions = {path: time for path, time in current.items() if ("/" not in path) or (time >= tmin)}
+   os.makedirs(os.path.dirname(os.path.abspath(args[1])), exist_ok=True)
+   with open(args[1], "w") as f:
+      json.dump({"host": socket.gethostname(), "nproc": stats["nproc"], "nthread": stats["nthread"], \
+         "regions": regions}, f, indent=2)
+   print("Baseline recorded in " + args[1] + " with " + str(len(regions)) + " regions")
+   sys.exit(0)
+
+if not os.path.exists(args[1]):
+   # No baseline, test skipped
+   print("No baseline in " + args[1] + ", record it with: saber_perf.py --record " + args[0] + " " + args[1])
+   sys.exit(skip_code)
+
+# Read baseline
+with open(args[1]) as f:
+   baseline = json.load(f)
+if baseline.get("host", "") != socket.gethostname():
+   print("Warning: baseline recorded on host " + baseline.get("host", "unknown") + ", timings may not be comparable")
+
+# Compare regions
+status = 0
+print("{:<60} {:>12} {:>12} {:>8}".format("region", "baseline (s)", "current (s)", "ratio"))
+for path, time_ref in sorted(baseline["regions"].items()):
+   if path not in current:
+      print("{:<60} {:>12.4f} {:>12} {:>8}".format(path, time_ref, "missing", ""))
+      status = max(status, 1)
+      continue
+   time = current[path]
+   ratio = time/time_ref if time_ref > 0.0 else 1.0
+   slower = (time > time_ref*(1.0+tolerance)) and (time-time_ref > tmin)
+   print("{:<60} {:>12.4f} {:>12.4f} {:>8.2f}{}".format(path, time_ref, time, ratio, "  SLOWER" if slower else ""))
+   if slower:
+      status = 2
+
+if status == 0:
+   print("Performance within tolerance (" + str(tolerance*100.0) + "%)")
+elif status == 1:
+   print("\033[31mRegions missing from the current timing\033[0m")
+else:
+   print("\033[31mPerformance regression beyond tolerance (" + str(tolerance*100.0) + "%)\033[0m")
+sys.exit(status)
@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+#----------------------------------------------------------------------
+# Python script: saber_timing_check
+# Author: Benjamin Menetrier
+# Licensing: this code is distributed under the CeCILL-C license
+# Copyright © 2015-... UCAR, CERFACS, METEO-FRANCE and IRIT
+#----------------------------------------------------------------------
+
+# Check the regions timing written by BUMP ('timing' key):
+# saber_timing_check.py <prefix>_timing.json <region path> [<region path> ...]
+# The test fails if a required region is missing, or if the statistics of a region are inconsistent (no call, negative
+# time, minimum larger than the mean or mean larger than the maximum, imbalance below one).
+
+import json
+import sys
+
+if len(sys.argv) < 3:
+   sys.exit("usage: saber_timing_check.py <prefix>_timing.json <region path> [<region path> ...]")
+eps = 1.0e-6
+
+# Read timing
+with open(sys.argv[1]) as f:
+   stats = json.load(f)
+if stats["nproc"] < 1 or stats["nthread"] < 1:
+   sys.exit("\033[31mWrong number of tasks or threads\033[0m")
+regions = {region["path"]: region for region in stats["regions"]}
+
+# Check required regions
+status = 0
+for path in sys.argv[2:]:
+   if path not in regions:
+      print("{:<60} missing".format(path))
+      status = 1
+
+# Check statistics
+for path, region in sorted(regions.items()):
+   errors = []
+   if region["calls"] < 1:
+      errors.append("no call")
+   for kind in ["task", "thread"]:
+      tmin, tmean, tmax = region[kind + "_min"], region[kind + "_mean"], region[kind + "_max"]
+      if tmin < 0.0:
+         errors.append(kind + " negative time")
+      if (tmin > tmean*(1.0+eps)+eps) or (tmean > tmax*(1.0+eps)+eps):
+         errors.append(kind + " min/mean/max inconsistent")
+      if (tmean > eps) and (region[kind + "_imbalance"] < 1.0-eps):
+         errors.append(kind + " imbalance below one")
+   print("{:<60} {:>8} {:>12.4f}  {}".format(path, region["calls"], region["task_max"], ", ".join(errors)))
+   if len(errors) > 0:
+      status = 1
+
+if status == 0:
+   print("Regions timing consistent")
+else:
+   print("\033[31mRegions timing missing or inconsistent\033[0m")
+sys.exit(status)